@@ -0,0 +1,38 @@
+#ifndef FS_WATCH_H
+#define FS_WATCH_H
+
+#include "quickjs.h"
+
+// 定义最大监听数和最大待派发事件数
+#define MAX_WATCHERS 64
+#define MAX_PENDING_WATCH_EVENTS 256
+
+// 默认防抖时间（毫秒）
+#define DEFAULT_WATCH_DEBOUNCE 50
+
+// 防抖最长等待时间（毫秒），持续写入的文件也会按此间隔派发事件
+#define MAX_WATCH_DEBOUNCE_WAIT 500
+
+// 获取 inotify 文件描述符，没有监听时返回 -1
+int fs_watch_fd(void);
+
+// 返回当前活动的监听数量
+int fs_watch_active_count(void);
+
+// 读取 inotify fd 上所有就绪的事件，并合并到待派发队列
+void fs_watch_read_events(void);
+
+// 派发防抖时间已到的事件（必要时先淘汰 require 缓存）
+void fs_watch_dispatch_events(void);
+
+// 距离下一个待派发事件到期的毫秒数，没有待派发事件时返回 -1
+int fs_watch_next_timeout(void);
+
+// 关闭所有监听并释放 inotify fd
+void free_fs_watchers(void);
+
+// 注册全局 fs 对象（fs.watch）
+// 参数：ctx - JavaScript 上下文
+void register_fs_watch(JSContext *ctx);
+
+#endif // FS_WATCH_H
@@ -6,6 +6,7 @@
 // 模块缓存结构
 typedef struct ModuleCache {
     char *filename;           // 模块文件名
+    char *key;                // 匹配键（真实路径或规范化的绝对路径），用于按文件淘汰
     JSValue exports;          // 模块的导出对象
     struct ModuleCache *next; // 链表用于处理冲突
 } ModuleCache;
@@ -16,6 +17,12 @@ ModuleCache *find_cached_module(const char *filename);
 // 将模块添加到缓存
 void add_module_to_cache(JSContext *ctx, const char *filename, JSValue exports);
 
+// 从缓存中移除指定文件对应的模块（按规范化的绝对路径匹配，文件可以已被删除），返回移除的数量
+int remove_module_from_cache(JSContext *ctx, const char *filename);
+
+// 从缓存中移除指定目录下的所有模块，返回移除的数量
+int remove_modules_in_directory(JSContext *ctx, const char *dir_path);
+
 // 清空模块缓存
 void free_module_cache(JSContext *ctx);
 
@@ -1,4 +1,5 @@
 #include "event_loop.h"
+#include "fs_watch.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -235,25 +236,53 @@ void event_loop_with_io(JSRuntime *rt, int fd) {
     fd_set read_fds;
     struct timeval timeout;
 
-    while (task_count > 0 || async_task_count > 0) {
+    while (task_count > 0 || async_task_count > 0 || fs_watch_active_count() > 0) {
         FD_ZERO(&read_fds);
+        int max_fd = -1;
 
         // 添加文件描述符到 select 监听
         if (fd >= 0) {
             FD_SET(fd, &read_fds);
+            max_fd = fd;
+        }
+
+        // 添加 fs.watch 共用的 inotify 文件描述符
+        int watch_fd = fs_watch_fd();
+        if (watch_fd >= 0) {
+            FD_SET(watch_fd, &read_fds);
+            if (watch_fd > max_fd) {
+                max_fd = watch_fd;
+            }
         }
 
         timeout.tv_sec = 0;
         timeout.tv_usec = 1000; // 1 毫秒的超时时间
+        struct timeval *timeout_ptr = &timeout;
+
+        // 只剩文件监听时阻塞等待，直到有事件或防抖到期，避免空转
+        if (task_count == 0 && async_task_count == 0) {
+            int watch_timeout = fs_watch_next_timeout();
+            if (watch_timeout < 0) {
+                timeout_ptr = NULL;
+            } else {
+                timeout.tv_sec = watch_timeout / 1000;
+                timeout.tv_usec = (watch_timeout % 1000) * 1000;
+            }
+        }
 
         // 检查文件描述符是否有可读数据
-        int ret = select(fd + 1, &read_fds, NULL, NULL, &timeout);
+        int ret = select(max_fd + 1, &read_fds, NULL, NULL, timeout_ptr);
         if (ret > 0 && fd >= 0 && FD_ISSET(fd, &read_fds)) {
             execute_async_tasks(rt);
         }
+        if (ret > 0 && watch_fd >= 0 && FD_ISSET(watch_fd, &read_fds)) {
+            fs_watch_read_events();
+        }
 
         // 执行到期任务
         execute_tasks();
+        // 派发防抖到期的文件变化事件
+        fs_watch_dispatch_events();
         // 执行挂起的 Promise 回调任务
         execute_pending_jobs(rt);
         // 执行异步任务
@@ -0,0 +1,691 @@
+#include "fs_watch.h"
+#include "module_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+
+// 监听父目录时使用的事件掩码（编辑器常以“写临时文件再 rename”方式保存，
+// 直接监听文件本身会在替换后失效）
+#define WATCH_MASK (IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | \
+                    IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF)
+
+// 事件类型标志，可按位合并
+#define WATCH_EVENT_CHANGE 0x1
+#define WATCH_EVENT_RENAME 0x2
+
+// 定义监听结构
+typedef struct {
+    int id;                       // 监听 ID
+    int wd;                       // inotify watch 描述符（-1 表示目录已失效，派发完剩余事件后关闭）
+    JSContext *ctx;               // JavaScript 上下文
+    JSValue callback;             // JavaScript 回调函数
+    char *dir_path;               // 被监听的目录（真实路径）
+    char *name;                   // 目录中的文件名（保留调用方给出的名字），监听整个目录时为 NULL
+    int target_wd;                // 符号链接目标所在目录的 wd，不是符号链接时为 -1
+    char *target_dir;             // 符号链接目标所在的目录（真实路径），不是符号链接时为 NULL
+    char *target_name;            // 符号链接目标的文件名
+    int debounce;                 // 防抖时间（毫秒）
+    bool invalidate_require;      // 变化时是否淘汰 require 缓存
+    bool overflow;                // 事件溢出，单个文件的事件已丢失
+    struct timespec overflow_first;    // 溢出时第一次事件的时间
+    struct timespec overflow_deadline; // 溢出事件的派发时间
+} Watcher;
+
+// 定义待派发事件结构（同一监听、同一文件的事件会合并为一条）
+typedef struct {
+    int watcher_id;               // 所属监听 ID
+    char name[NAME_MAX + 1];      // 发生变化的文件名，空字符串表示目录本身
+    int events;                   // 合并后的事件类型
+    struct timespec first;        // 第一次事件的时间
+    struct timespec deadline;     // 防抖到期时间
+} PendingWatchEvent;
+
+// inotify 文件描述符，所有监听共用一个
+static int inotify_fd = -1;
+
+// 监听表
+static Watcher watchers[MAX_WATCHERS];
+static int watcher_count = 0;
+
+// 待派发事件队列
+static PendingWatchEvent pending_events[MAX_PENDING_WATCH_EVENTS];
+static int pending_count = 0;
+
+// 用于生成监听 ID
+static int next_watcher_id = 1;
+
+// 计算 time + delay 毫秒后的时间点
+static struct timespec time_after(const struct timespec *time, int delay) {
+    struct timespec result = {
+        .tv_sec = time->tv_sec + delay / 1000,
+        .tv_nsec = time->tv_nsec + (delay % 1000) * 1000000,
+    };
+    if (result.tv_nsec >= 1000000000) {
+        result.tv_sec += 1;
+        result.tv_nsec -= 1000000000;
+    }
+    return result;
+}
+
+// 判断时间点是否已到
+static bool deadline_passed(const struct timespec *deadline, const struct timespec *now) {
+    return deadline->tv_sec < now->tv_sec ||
+           (deadline->tv_sec == now->tv_sec && deadline->tv_nsec <= now->tv_nsec);
+}
+
+// 计算防抖到期时间：每次新事件推迟到 now + debounce，
+// 但最多等到 first + max(debounce, MAX_WATCH_DEBOUNCE_WAIT)，持续写入也能派发
+static struct timespec debounce_deadline(const struct timespec *first, int debounce) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    struct timespec deadline = time_after(&now, debounce);
+    int max_wait = debounce > MAX_WATCH_DEBOUNCE_WAIT ? debounce : MAX_WATCH_DEBOUNCE_WAIT;
+    struct timespec limit = time_after(first, max_wait);
+    return deadline_passed(&limit, &deadline) ? limit : deadline;
+}
+
+// 根据 ID 查找监听
+static Watcher *find_watcher(int id) {
+    for (int i = 0; i < watcher_count; i++) {
+        if (watchers[i].id == id) {
+            return &watchers[i];
+        }
+    }
+    return NULL;
+}
+
+// 移除属于指定监听的待派发事件
+static void remove_pending_events(int watcher_id) {
+    int kept = 0;
+    for (int i = 0; i < pending_count; i++) {
+        if (pending_events[i].watcher_id != watcher_id) {
+            pending_events[kept++] = pending_events[i];
+        }
+    }
+    pending_count = kept;
+}
+
+// 判断监听是否还有未派发的事件
+static bool has_pending_events(const Watcher *watcher) {
+    if (watcher->overflow) {
+        return true;
+    }
+    for (int i = 0; i < pending_count; i++) {
+        if (pending_events[i].watcher_id == watcher->id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 释放 wd：同一目录可能被多个监听（或同一监听的链接和目标）共用，只有没人使用时才真正移除
+static void release_watch(int wd) {
+    if (wd < 0 || inotify_fd < 0) {
+        return;
+    }
+    for (int i = 0; i < watcher_count; i++) {
+        if (watchers[i].wd == wd || watchers[i].target_wd == wd) {
+            return;
+        }
+    }
+    inotify_rm_watch(inotify_fd, wd);
+}
+
+// 移除监听
+static void remove_watcher(int id) {
+    for (int i = 0; i < watcher_count; i++) {
+        if (watchers[i].id != id) {
+            continue;
+        }
+        Watcher *watcher = &watchers[i];
+        int wd = watcher->wd;
+        int target_wd = watcher->target_wd;
+
+        // 释放监听的资源
+        JS_FreeValue(watcher->ctx, watcher->callback);
+        free(watcher->dir_path);
+        free(watcher->name);
+        free(watcher->target_dir);
+        free(watcher->target_name);
+        remove_pending_events(id);
+
+        // 将后续监听向前移动，覆盖当前监听
+        for (int j = i; j < watcher_count - 1; j++) {
+            watchers[j] = watchers[j + 1];
+        }
+        watcher_count--;
+
+        release_watch(wd);
+        release_watch(target_wd);
+        break;
+    }
+
+    // 没有监听时关闭 inotify fd，让事件循环可以退出
+    if (watcher_count == 0 && inotify_fd >= 0) {
+        close(inotify_fd);
+        inotify_fd = -1;
+    }
+}
+
+// 标记监听溢出：丢弃该监听逐个文件的事件，改为派发一次整体 rename
+static void mark_watcher_overflow(Watcher *watcher) {
+    remove_pending_events(watcher->id);
+    if (!watcher->overflow) {
+        watcher->overflow = true;
+        clock_gettime(CLOCK_MONOTONIC, &watcher->overflow_first);
+    }
+    watcher->overflow_deadline = debounce_deadline(&watcher->overflow_first, watcher->debounce);
+}
+
+// 将事件合并到待派发队列
+static void queue_watch_event(Watcher *watcher, const char *name, int events) {
+    // 已溢出的监听会整体派发，只需推迟到期时间
+    if (watcher->overflow) {
+        mark_watcher_overflow(watcher);
+        return;
+    }
+
+    for (int i = 0; i < pending_count; i++) {
+        PendingWatchEvent *pending = &pending_events[i];
+        if (pending->watcher_id == watcher->id && strcmp(pending->name, name) == 0) {
+            pending->events |= events;
+            pending->deadline = debounce_deadline(&pending->first, watcher->debounce);
+            return;
+        }
+    }
+
+    // 队列已满时不能丢弃事件，否则监听者和 require 缓存都不会知道文件变化
+    if (pending_count >= MAX_PENDING_WATCH_EVENTS) {
+        mark_watcher_overflow(watcher);
+        return;
+    }
+
+    PendingWatchEvent *pending = &pending_events[pending_count++];
+    pending->watcher_id = watcher->id;
+    snprintf(pending->name, sizeof(pending->name), "%s", name);
+    pending->events = events;
+    clock_gettime(CLOCK_MONOTONIC, &pending->first);
+    pending->deadline = debounce_deadline(&pending->first, watcher->debounce);
+}
+
+// 目录被删除或移走，wd 对应的监听全部失效
+static void invalidate_watch(int wd, uint32_t mask) {
+    // IN_MOVE_SELF 之后内核仍保留 watch，但路径已经过时，主动移除
+    if ((mask & IN_MOVE_SELF) && inotify_fd >= 0) {
+        inotify_rm_watch(inotify_fd, wd);
+    }
+
+    for (int i = 0; i < watcher_count; i++) {
+        Watcher *watcher = &watchers[i];
+        if (watcher->wd != wd && watcher->target_wd != wd) {
+            continue;
+        }
+        queue_watch_event(watcher, watcher->name ? watcher->name : "", WATCH_EVENT_RENAME);
+
+        // 符号链接目标所在目录失效时只停止跟踪目标，链接本身仍在监听
+        if (watcher->target_wd == wd) {
+            watcher->target_wd = -1;
+        }
+        // 派发最后一次 rename 后关闭监听（见 fs_watch_dispatch_events）
+        if (watcher->wd == wd) {
+            watcher->wd = -1;
+        }
+    }
+}
+
+// 获取 inotify 文件描述符
+int fs_watch_fd(void) {
+    return inotify_fd;
+}
+
+// 返回当前活动的监听数量
+int fs_watch_active_count(void) {
+    return watcher_count;
+}
+
+// 读取 inotify 事件
+void fs_watch_read_events(void) {
+    if (inotify_fd < 0) {
+        return;
+    }
+
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    while (true) {
+        ssize_t len = read(inotify_fd, buffer, sizeof(buffer));
+        if (len <= 0) {
+            break; // EAGAIN：没有更多事件
+        }
+
+        for (char *ptr = buffer; ptr < buffer + len;) {
+            const struct inotify_event *event = (const struct inotify_event *)ptr;
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            // 内核事件队列溢出（wd 为 -1），无法知道哪些文件变化，所有监听都需要整体通知
+            if (event->mask & IN_Q_OVERFLOW) {
+                for (int i = 0; i < watcher_count; i++) {
+                    mark_watcher_overflow(&watchers[i]);
+                }
+                continue;
+            }
+
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                invalidate_watch(event->wd, event->mask);
+                continue;
+            }
+
+            int events = 0;
+            if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
+                events |= WATCH_EVENT_CHANGE;
+            }
+            if (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) {
+                events |= WATCH_EVENT_RENAME;
+            }
+            if (!events || event->len == 0) {
+                continue;
+            }
+
+            // 只遍历监听表，开销与事件数量成正比，而不是与文件数量成正比
+            for (int i = 0; i < watcher_count; i++) {
+                Watcher *watcher = &watchers[i];
+                // 链接所在目录按调用方给出的文件名过滤（链接被替换或重新指向）
+                bool matched = watcher->wd == event->wd &&
+                               (!watcher->name || strcmp(watcher->name, event->name) == 0);
+                // 符号链接目标所在目录按目标文件名过滤（目标文件被编辑）
+                if (!matched && watcher->target_name && watcher->target_wd == event->wd) {
+                    matched = strcmp(watcher->target_name, event->name) == 0;
+                }
+                if (!matched) {
+                    continue; // 同目录下的其他文件
+                }
+                // 统一以调用方给出的文件名派发
+                queue_watch_event(watcher, watcher->name ? watcher->name : event->name, events);
+            }
+        }
+    }
+}
+
+// 调用监听回调，name 为 NULL 时表示无法确定具体文件
+static void call_watch_listener(Watcher *watcher, const char *event_type, const char *name) {
+    JSContext *ctx = watcher->ctx;
+    JSValue args[2] = {
+        JS_NewString(ctx, event_type),
+        name ? JS_NewString(ctx, name) : JS_NULL,
+    };
+
+    // 回调中可能关闭当前监听，先增加回调的引用计数
+    JSValue callback = JS_DupValue(ctx, watcher->callback);
+    JSValue result = JS_Call(ctx, callback, JS_UNDEFINED, 2, args);
+    if (JS_IsException(result)) {
+        JSValue exception = JS_GetException(ctx);
+        const char *error = JS_ToCString(ctx, exception);
+        printf("fs.watch callback failed: %s\n", error);
+        JS_FreeCString(ctx, error);
+        JS_FreeValue(ctx, exception);
+    }
+
+    // 释放资源
+    JS_FreeValue(ctx, result);
+    JS_FreeValue(ctx, callback);
+    JS_FreeValue(ctx, args[0]);
+    JS_FreeValue(ctx, args[1]);
+}
+
+// 根据文件路径计算符号链接目标所在的目录和文件名，不是符号链接时返回 -1
+static int resolve_symlink_target(const char *path, char **target_dir, char **target_name) {
+    struct stat st;
+    char resolved[PATH_MAX];
+
+    if (lstat(path, &st) < 0 || !S_ISLNK(st.st_mode) || !realpath(path, resolved)) {
+        return -1;
+    }
+
+    char *slash = strrchr(resolved, '/');
+    *target_name = strdup(slash + 1);
+    *target_dir = slash == resolved ? strdup("/") : strndup(resolved, slash - resolved);
+    return 0;
+}
+
+// 链接被重新指向或替换后，改为跟踪新的目标
+static void refresh_symlink_target(Watcher *watcher) {
+    if (!watcher->name || watcher->wd < 0) {
+        return;
+    }
+
+    char path[PATH_MAX];
+    char *target_dir = NULL;
+    char *target_name = NULL;
+    snprintf(path, sizeof(path), "%s/%s", watcher->dir_path, watcher->name);
+    resolve_symlink_target(path, &target_dir, &target_name);
+
+    // 目标没有变化
+    if (target_dir && watcher->target_dir && watcher->target_wd >= 0 &&
+        strcmp(target_dir, watcher->target_dir) == 0 &&
+        strcmp(target_name, watcher->target_name) == 0) {
+        free(target_dir);
+        free(target_name);
+        return;
+    }
+
+    int old_wd = watcher->target_wd;
+    free(watcher->target_dir);
+    free(watcher->target_name);
+    watcher->target_dir = target_dir;
+    watcher->target_name = target_name;
+    watcher->target_wd = target_dir ? inotify_add_watch(inotify_fd, target_dir, WATCH_MASK) : -1;
+    release_watch(old_wd);
+}
+
+// 派发一次溢出事件
+static void dispatch_overflow(Watcher *watcher) {
+    watcher->overflow = false;
+
+    // 无法确定哪些文件变化，淘汰目录下所有缓存的模块
+    if (watcher->invalidate_require) {
+        remove_modules_in_directory(watcher->ctx, watcher->dir_path);
+        if (watcher->target_dir) {
+            remove_modules_in_directory(watcher->ctx, watcher->target_dir);
+        }
+    }
+    refresh_symlink_target(watcher);
+    call_watch_listener(watcher, "rename", watcher->name);
+}
+
+// 派发一条合并后的事件
+static void dispatch_pending(Watcher *watcher, const PendingWatchEvent *pending) {
+    // 先淘汰 require 缓存，回调中再次 require() 即可拿到新的导出
+    if (watcher->invalidate_require) {
+        if (pending->name[0] != '\0') {
+            char path[PATH_MAX];
+            snprintf(path, sizeof(path), "%s/%s", watcher->dir_path, pending->name);
+            remove_module_from_cache(watcher->ctx, path);
+
+            // 链接可能已重新指向，旧目标的缓存也要淘汰
+            if (watcher->target_dir) {
+                snprintf(path, sizeof(path), "%s/%s", watcher->target_dir, watcher->target_name);
+                remove_module_from_cache(watcher->ctx, path);
+            }
+        } else {
+            remove_modules_in_directory(watcher->ctx, watcher->dir_path);
+        }
+    }
+
+    refresh_symlink_target(watcher);
+
+    // rename 优先于 change
+    const char *event_type = (pending->events & WATCH_EVENT_RENAME) ? "rename" : "change";
+    call_watch_listener(watcher, event_type, pending->name[0] != '\0' ? pending->name : NULL);
+}
+
+// 派发到期的事件
+void fs_watch_dispatch_events(void) {
+    while (true) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        // 每次重新扫描，回调中可能关闭监听或产生新事件
+        int watcher_id = -1;
+        for (int i = 0; i < watcher_count; i++) {
+            if (watchers[i].overflow && deadline_passed(&watchers[i].overflow_deadline, &now)) {
+                watcher_id = watchers[i].id;
+                dispatch_overflow(&watchers[i]);
+                break;
+            }
+        }
+
+        if (watcher_id < 0) {
+            int index = -1;
+            for (int i = 0; i < pending_count; i++) {
+                if (deadline_passed(&pending_events[i].deadline, &now)) {
+                    index = i;
+                    break;
+                }
+            }
+            if (index < 0) {
+                break;
+            }
+
+            // 取出事件，并将后续事件向前移动
+            PendingWatchEvent pending = pending_events[index];
+            for (int j = index; j < pending_count - 1; j++) {
+                pending_events[j] = pending_events[j + 1];
+            }
+            pending_count--;
+
+            Watcher *watcher = find_watcher(pending.watcher_id);
+            if (!watcher) {
+                continue;
+            }
+            watcher_id = watcher->id;
+            dispatch_pending(watcher, &pending);
+        }
+
+        // 目录已失效的监听在派发完最后的事件后关闭，不能让事件循环一直阻塞
+        Watcher *watcher = find_watcher(watcher_id);
+        if (watcher && watcher->wd < 0 && !has_pending_events(watcher)) {
+            remove_watcher(watcher_id);
+        }
+    }
+}
+
+// 距离下一个事件到期的毫秒数
+int fs_watch_next_timeout(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    long min_ms = -1;
+    for (int i = 0; i < pending_count + watcher_count; i++) {
+        const struct timespec *deadline;
+        if (i < pending_count) {
+            deadline = &pending_events[i].deadline;
+        } else if (watchers[i - pending_count].overflow) {
+            deadline = &watchers[i - pending_count].overflow_deadline;
+        } else {
+            continue;
+        }
+
+        // 向上取整到毫秒，避免不足 1 毫秒时 select 超时为 0 而空转
+        long long ns = (long long)(deadline->tv_sec - now.tv_sec) * 1000000000LL +
+                       (deadline->tv_nsec - now.tv_nsec);
+        long ms = ns > 0 ? (long)((ns + 999999) / 1000000) : 0;
+        if (min_ms < 0 || ms < min_ms) {
+            min_ms = ms;
+        }
+    }
+    return (int)min_ms;
+}
+
+// 关闭所有监听
+void free_fs_watchers(void) {
+    while (watcher_count > 0) {
+        remove_watcher(watchers[watcher_count - 1].id);
+    }
+    pending_count = 0;
+}
+
+// 监听对象的 close 方法，func_data[0] 保存监听 ID
+static JSValue js_watcher_close(JSContext *ctx, JSValueConst this_val,
+                                int argc, JSValueConst *argv, int magic, JSValue *func_data) {
+    int id;
+    if (JS_ToInt32(ctx, &id, func_data[0]) == 0) {
+        remove_watcher(id);
+    }
+    return JS_UNDEFINED;
+}
+
+// 解析监听路径：目录直接解析为真实路径；文件只解析父目录，
+// 文件名保持调用方给出的样子（监听 config.js -> config.prod.js 这类符号链接时，
+// 原子替换 config.js 产生的事件才能匹配上），链接目标由 resolve_symlink_target 另行监听
+static int resolve_watch_path(const char *file_path, char **dir_path, char **name) {
+    struct stat st;
+    char resolved[PATH_MAX];
+
+    if (stat(file_path, &st) < 0) {
+        return -1;
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+        if (!realpath(file_path, resolved)) {
+            return -1;
+        }
+        *dir_path = strdup(resolved);
+        *name = NULL;
+        return 0;
+    }
+
+    char parent[PATH_MAX];
+    const char *slash = strrchr(file_path, '/');
+    if (!slash) {
+        snprintf(parent, sizeof(parent), ".");
+    } else if (slash == file_path) {
+        snprintf(parent, sizeof(parent), "/");
+    } else {
+        snprintf(parent, sizeof(parent), "%.*s", (int)(slash - file_path), file_path);
+    }
+
+    if (!realpath(parent, resolved)) {
+        return -1;
+    }
+    *dir_path = strdup(resolved);
+    *name = strdup(slash ? slash + 1 : file_path);
+    return 0;
+}
+
+// JavaScript 的 fs.watch 实现
+// 用法：fs.watch(filename[, options], listener)
+// options：{ debounce: 毫秒, invalidateRequire: 布尔值 }
+static JSValue js_fs_watch(JSContext *ctx, JSValueConst this_val,
+                           int argc, JSValueConst *argv) {
+    JSValueConst options = JS_UNDEFINED;
+    JSValueConst listener = JS_UNDEFINED;
+    if (argc >= 3) {
+        options = argv[1];
+        listener = argv[2];
+    } else if (argc == 2) {
+        listener = argv[1];
+    }
+    if (argc < 2 || !JS_IsFunction(ctx, listener)) {
+        return JS_ThrowTypeError(ctx, "Invalid arguments: Expected file path and listener function");
+    }
+
+    // 解析选项
+    int debounce = DEFAULT_WATCH_DEBOUNCE;
+    bool invalidate_require = false;
+    if (JS_IsObject(options)) {
+        JSValue val = JS_GetPropertyStr(ctx, options, "debounce");
+        if (!JS_IsUndefined(val) && JS_ToInt32(ctx, &debounce, val) < 0) {
+            JS_FreeValue(ctx, val);
+            return JS_EXCEPTION;
+        }
+        JS_FreeValue(ctx, val);
+        if (debounce < 0) {
+            debounce = 0;
+        }
+
+        val = JS_GetPropertyStr(ctx, options, "invalidateRequire");
+        invalidate_require = JS_ToBool(ctx, val) > 0;
+        JS_FreeValue(ctx, val);
+    }
+
+    if (watcher_count >= MAX_WATCHERS) {
+        return JS_ThrowInternalError(ctx, "Too many watchers");
+    }
+
+    const char *file_path = JS_ToCString(ctx, argv[0]);
+    if (!file_path) {
+        return JS_ThrowTypeError(ctx, "Invalid file path");
+    }
+
+    // 监听文件时实际监听其所在目录，再按文件名过滤
+    char *dir_path = NULL;
+    char *name = NULL;
+    if (resolve_watch_path(file_path, &dir_path, &name) < 0) {
+        JSValue error = JS_ThrowInternalError(ctx, "Failed to watch %s: %s", file_path, strerror(errno));
+        JS_FreeCString(ctx, file_path);
+        return error;
+    }
+    JS_FreeCString(ctx, file_path);
+
+    // 文件是符号链接时，还要监听目标所在目录，否则编辑目标文件不会触发事件
+    char *target_dir = NULL;
+    char *target_name = NULL;
+    if (name) {
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "%s/%s", dir_path, name);
+        resolve_symlink_target(path, &target_dir, &target_name);
+    }
+
+    // 第一次监听时创建 inotify fd（非阻塞，由事件循环统一 select）
+    if (inotify_fd < 0) {
+        inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd < 0) {
+            free(dir_path);
+            free(name);
+            free(target_dir);
+            free(target_name);
+            return JS_ThrowInternalError(ctx, "Failed to init inotify: %s", strerror(errno));
+        }
+    }
+
+    int wd = inotify_add_watch(inotify_fd, dir_path, WATCH_MASK);
+    int target_wd = target_dir ? inotify_add_watch(inotify_fd, target_dir, WATCH_MASK) : -1;
+    if (wd < 0 || (target_dir && target_wd < 0)) {
+        const char *failed_path = wd < 0 ? dir_path : target_dir;
+        JSValue error = JS_ThrowInternalError(ctx, "Failed to watch %s: %s", failed_path, strerror(errno));
+        release_watch(wd);
+        release_watch(target_wd);
+        free(dir_path);
+        free(name);
+        free(target_dir);
+        free(target_name);
+        if (watcher_count == 0) {
+            close(inotify_fd);
+            inotify_fd = -1;
+        }
+        return error;
+    }
+
+    // 创建监听
+    Watcher *watcher = &watchers[watcher_count++];
+    watcher->id = next_watcher_id++;
+    watcher->wd = wd;
+    watcher->ctx = ctx;
+    watcher->callback = JS_DupValue(ctx, listener);
+    watcher->dir_path = dir_path;
+    watcher->name = name;
+    watcher->target_wd = target_wd;
+    watcher->target_dir = target_dir;
+    watcher->target_name = target_name;
+    watcher->debounce = debounce;
+    watcher->invalidate_require = invalidate_require;
+    watcher->overflow = false;
+
+    // 返回带 close 方法的监听对象
+    JSValue id_val = JS_NewInt32(ctx, watcher->id);
+    JSValue watcher_obj = JS_NewObject(ctx);
+    JS_SetPropertyStr(ctx, watcher_obj, "close",
+                      JS_NewCFunctionData(ctx, js_watcher_close, 0, 0, 1, &id_val));
+    return watcher_obj;
+}
+
+// 注册全局 fs 对象
+void register_fs_watch(JSContext *ctx) {
+    JSValue fs = JS_NewObject(ctx);
+
+    // 添加 watch 方法
+    JS_SetPropertyStr(ctx, fs, "watch",
+                      JS_NewCFunction(ctx, js_fs_watch, "watch", 3));
+
+    // 将 fs 对象挂载到全局对象上
+    JSValue global_obj = JS_GetGlobalObject(ctx);
+    JS_SetPropertyStr(ctx, global_obj, "fs", fs);
+    JS_FreeValue(ctx, global_obj);
+}
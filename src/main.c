@@ -4,6 +4,7 @@
 #include "event_loop.h"
 #include "console.h"
 #include "require.h"
+#include "fs_watch.h"
 
 // 主程序入口
 int main(int argc, char **argv) {
@@ -37,6 +38,9 @@ int main(int argc, char **argv) {
     // 注册 setTimeout 和 clearTimeout
     register_global_functions(ctx);
 
+    // 注册 fs.watch
+    register_fs_watch(ctx);
+
     // 读取脚本文件内容
     FILE *file = fopen(script_file, "r");
     if (!file) {
@@ -87,6 +91,9 @@ int main(int argc, char **argv) {
     execute_pending_jobs(runtime); // 处理所有 Promise 回调
     event_loop_with_io(runtime, -1); // -1 表示没有额外的文件描述符需要监听
 
+    // 关闭剩余的文件监听
+    free_fs_watchers();
+
     // 释放 QuickJS 运行时和上下文
     JS_FreeContext(ctx);
     JS_FreeRuntime(runtime);
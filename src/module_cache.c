@@ -1,6 +1,9 @@
+#include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include "quickjs.h"
 #include <string.h>
+#include <limits.h>
 #include "module_cache.h"
 
 // 全局模块缓存表
@@ -18,22 +21,134 @@ ModuleCache *find_cached_module(const char *filename) {
     return NULL;
 }
 
+// 将路径规范化为绝对路径：相对路径拼接 cwd，并折叠 . 和 ..
+// 只做字符串处理，不要求文件仍然存在（被删除的文件也能匹配）
+static int normalize_path(const char *path, char *out, size_t size) {
+    char buf[PATH_MAX * 2];
+    if (path[0] == '/') {
+        snprintf(buf, sizeof(buf), "%s", path);
+    } else {
+        char cwd[PATH_MAX];
+        if (!getcwd(cwd, sizeof(cwd))) {
+            return -1;
+        }
+        snprintf(buf, sizeof(buf), "%s/%s", cwd, path);
+    }
+
+    size_t len = 0;
+    out[0] = '\0';
+    char *save = NULL;
+    for (char *part = strtok_r(buf, "/", &save); part; part = strtok_r(NULL, "/", &save)) {
+        if (strcmp(part, ".") == 0) {
+            continue;
+        }
+        if (strcmp(part, "..") == 0) {
+            // 回退到上一级目录
+            char *slash = strrchr(out, '/');
+            if (slash) {
+                *slash = '\0';
+                len = slash - out;
+            }
+            continue;
+        }
+
+        size_t part_len = strlen(part);
+        if (len + 1 + part_len >= size) {
+            return -1;
+        }
+        out[len++] = '/';
+        memcpy(out + len, part, part_len);
+        len += part_len;
+        out[len] = '\0';
+    }
+
+    if (len == 0) {
+        snprintf(out, size, "/");
+    }
+    return 0;
+}
+
+// 计算模块的缓存匹配键：文件存在时取真实路径（处理符号链接），否则取规范化的绝对路径
+static int module_cache_key(const char *path, char *out, size_t size) {
+    char resolved[PATH_MAX];
+    if (realpath(path, resolved)) {
+        snprintf(out, size, "%s", resolved);
+        return 0;
+    }
+    return normalize_path(path, out, size);
+}
+
 // 将模块添加到缓存
 void add_module_to_cache(JSContext *ctx, const char *filename, JSValue exports) {
     ModuleCache *new_module = malloc(sizeof(ModuleCache));
     new_module->filename = strdup(filename);
+
+    // 匹配键在加入缓存时计算一次，淘汰时只需字符串比较
+    char key[PATH_MAX];
+    new_module->key = module_cache_key(filename, key, sizeof(key)) == 0 ? strdup(key) : NULL;
     new_module->exports = JS_DupValue(ctx, exports); // 增加引用计数
     new_module->next = module_cache;
     module_cache = new_module;
 }
 
+// 判断 path 是否等于 target（under_dir 为真时判断 path 是否位于 target 目录之下）
+static int path_matches(const char *path, const char *target, int under_dir) {
+    if (!under_dir) {
+        return strcmp(path, target) == 0;
+    }
+    size_t target_len = strlen(target);
+    if (target_len == 1 && target[0] == '/') {
+        return path[0] == '/';
+    }
+    return strncmp(path, target, target_len) == 0 && path[target_len] == '/';
+}
+
+// 从缓存中移除所有匹配 target 的模块，返回移除的数量
+static int remove_matching_modules(JSContext *ctx, const char *target, int under_dir) {
+    // 目标路径每次调用只规范化一次
+    char target_key[PATH_MAX];
+    if (module_cache_key(target, target_key, sizeof(target_key)) < 0) {
+        return 0;
+    }
+    int removed = 0;
+
+    ModuleCache **link = &module_cache;
+    while (*link) {
+        ModuleCache *current = *link;
+        // require() 以调用方传入的原始路径作为缓存键，这里比较规范化后的匹配键
+        if (current->key && path_matches(current->key, target_key, under_dir)) {
+            // 从链表中摘除并释放
+            *link = current->next;
+            free(current->filename);
+            free(current->key);
+            JS_FreeValue(ctx, current->exports);
+            free(current);
+            removed++;
+        } else {
+            link = &current->next;
+        }
+    }
+    return removed;
+}
+
+// 从缓存中移除指定文件对应的模块
+int remove_module_from_cache(JSContext *ctx, const char *filename) {
+    return remove_matching_modules(ctx, filename, 0);
+}
+
+// 从缓存中移除指定目录下的所有模块
+int remove_modules_in_directory(JSContext *ctx, const char *dir_path) {
+    return remove_matching_modules(ctx, dir_path, 1);
+}
+
 // 清空模块缓存
 void free_module_cache(JSContext *ctx) {
     ModuleCache *current = module_cache;
     while (current) {
         ModuleCache *next = current->next;
-        // 释放 filename
+        // 释放 filename 和匹配键
         free(current->filename);
+        free(current->key);
 
         // 释放 exports
         JS_FreeValue(ctx, current->exports);
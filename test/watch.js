@@ -0,0 +1,59 @@
+// 测试 fs.watch：由 `make watch` 在临时目录中运行（cwd 为临时目录，不会改动仓库里的文件）。
+// Makefile 依次：原地重写 utils.js、原子替换 utils.js、编辑 config.js 指向的 config.prod.js、
+// 将 config.js 重新指向 config.new.js、编辑 config.new.js。
+// 全部检查通过时输出 "watch test passed"，Makefile 据此判断成败。
+const expected = {
+    utils: ["change", "rename"],
+    config: ["change", "rename", "change"],
+};
+const seen = { utils: [], config: [] };
+const failures = [];
+
+let utils = require('./utils.js');
+let config = require('./config.js');
+
+const utilsWatcher = fs.watch('./utils.js', { debounce: 100, invalidateRequire: true }, (eventType, filename) => {
+    const previous = utils;
+    utils = require('./utils.js');
+    seen.utils.push(eventType);
+    console.log("utils:", eventType, filename);
+    if (previous === utils) {
+        failures.push("utils.js exports not evicted after " + eventType);
+    }
+});
+
+// config.js 是符号链接，编辑目标文件和重新指向链接都要触发，并以 config.js 的名字派发
+const configWatcher = fs.watch('./config.js', { debounce: 100, invalidateRequire: true }, (eventType, filename) => {
+    const previous = config;
+    config = require('./config.js');
+    seen.config.push(eventType);
+    console.log("config:", eventType, filename, config.env);
+    if (previous === config) {
+        failures.push("config.js exports not evicted after " + eventType);
+    }
+    if (filename !== "config.js") {
+        failures.push("config.js event dispatched as " + filename);
+    }
+});
+
+// Makefile 在 5 秒内完成所有修改，之后检查结果并关闭监听
+setTimeout(() => {
+    utilsWatcher.close();
+    configWatcher.close();
+
+    for (const key in expected) {
+        if (seen[key].join(",") !== expected[key].join(",")) {
+            failures.push(key + " events: expected [" + expected[key] + "], got [" + seen[key] + "]");
+        }
+    }
+    if (config.env !== "new") {
+        failures.push("config.js should point to config.new.js, got env " + config.env);
+    }
+
+    if (failures.length > 0) {
+        console.log("watch test FAILED:");
+        failures.forEach((failure) => console.log("  " + failure));
+    } else {
+        console.log("watch test passed");
+    }
+}, 6500);